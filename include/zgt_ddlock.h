@@ -13,32 +13,47 @@
 #include <stddef.h>
 #define FALSE	0
 
+/* A node of the wait-for graph. Each waiting Tx has one node in wtable, */
+/* linked by next/prev and found through its Tx table record; the Txs it */
+/* waits for hang off it in a chain of nodes linked by next_s. level,   */
+/* parent and iter are used by the cycle search.                         */
+
 struct node
 {
 	long tid;
 	long sgno;
 	long obno;
 	char lockmode;
-	int semno;
-	int level;
+	int level;	// 0 = not visited, > 0 = on the search path, -1 = done
 	node*	next;
+	node*	prev;
 	node*	next_s;
 	node*	parent;
+	node*	iter;	// Next edge to follow in the cycle search
 };
 
+/* Wait-for graph. It is kept up to date as requests block and are */
+/* granted, so a search for cycles never has to scan the lock table. */
+
 class wait_for
 {
-    node*	head;
     node*	wtable;
     int	found;
+    int	choose;		// Pick a victim for the cycle found; else only report it
     node*	victim;
+    long	victimtid;	// tid of victim, kept once the graph is unlatched
+    zgt_latch latch;
 
-    int visited(long);
     node* location(long);
     int traverse(node *);
+    void free_edges(node *);
     node* choose_victim(node *, node *);
+    void print_cycle(node *, node *);
     public:
-    int deadlock();
+    int block(long, zgt_hlink *);
+    void unblock(long);
+    int deadlock(int choose = TRUE);
+    long victim_tid() {return(victimtid);}
     wait_for();
-    ~wait_for(){};
+    ~wait_for();
 };
@@ -11,7 +11,41 @@
 
 #include <stddef.h>
 
-#define  ZGT_DEFAULT_HASH_TABLE_SIZE  13
+#define  ZGT_DEFAULT_HASH_TABLE_SIZE  16 // Initial # of slots per lock table shard; power of 2
+#define  ZGT_HT_SHARD_BITS  4               // Lock table has 2^ZGT_HT_SHARD_BITS shards
+#define  ZGT_HT_NSHARDS  (1 << ZGT_HT_SHARD_BITS)
+#define  ZGT_HT_MAX_LOAD  70                // A shard doubles when more than this % of slots is used
+
+/* Lock modes. Objects are locked S or X; their segments (sgno) also in */
+/* the intention modes, which a Tx takes on a segment before it locks  */
+/* objects in it. SIX is S on the whole segment with X on some objects. */
+
+#define  ZGT_LOCK_IS   'i'
+#define  ZGT_LOCK_IX   'x'
+#define  ZGT_LOCK_S    'S'
+#define  ZGT_LOCK_SIX  'y'
+#define  ZGT_LOCK_X    'X'
+
+#define  ZGT_SEGMENT  -2    // obno of the lock on a segment as a whole
+#define  ZGT_SEG_SIZE  1024 // Objects per segment; 0 = objects are locked on their own
+#define  ZGT_ESCALATE  128  // Object locks of a Tx in a segment before it locks the segment instead; 0 = never
+
+#define  ZGT_TX_SLAB  32         // Tx table: records are allocated this many at a time, per shard
+#define  ZGT_TX_SHARD_BITS  6    // Tx table: 2^ZGT_TX_SHARD_BITS shards, each with its own latch
+#define  ZGT_TX_CHAINS  16       // Hash chains of a shard at first; doubles as the records grow
+
+#define ZGT_SEM_WORK   0 // Counts the Txs in the run queue; idle workers wait on it
+#define ZGT_SEM_DRAIN  1 // endTm waits on it for the scheduled operations to finish
+#define ZGT_SEM_WAL    2 // The redo log flusher waits on it for commits to write out
+#define ZGT_NSEMA      3
+
+#define ZGT_DD_DETECT      'D' // Deadlocks: wait-for graph and cycle detection
+#define ZGT_DD_WAIT_DIE    'W' // Deadlocks prevented: a younger requester aborts
+#define ZGT_DD_WOUND_WAIT  'O' // Deadlocks prevented: an older requester aborts the holder
+#define ZGT_DDLOCK_INTERVAL 50 // ms between background deadlock checks; 0 = on Detect/Choose only
+
+#define ZGT_VICTIM_YOUNGEST     'Y' // Abort the Tx in the cycle that began last
+#define ZGT_VICTIM_FEWEST_LOCKS 'L' // Abort the Tx in the cycle holding the fewest locks
 
 #define NTRANSACTION_TYPES 2
 #define ODD 1
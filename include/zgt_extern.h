@@ -16,9 +16,7 @@ extern  void *aborttx(void *);
 extern  void *committx(void *);
 extern  zgt_tx* get_tx(long);
 extern  int zgt_init_sema(int);
-extern void  zgt_init_sema_0(int);
-extern void  zgt_init_sema_rest(int);
-extern int   zgt_sem_release(int);
+extern int   zgt_sem_release();
 
 extern int  zgt_p(int);
 extern int  zgt_v(int);
@@ -34,20 +32,35 @@ extern zgt_tx *ZGT_Tx;
 extern int errno;
 
 
-extern key_t ZGT_Key_sem;
-extern int ZGT_Semid ;
+extern zgt_sema *ZGT_Sema;
 extern int ZGT_Nsema ;
+extern zgt_pool ZGT_Pool[];
 
 extern int system(char *);
 extern int ZGT_Initp;
 extern int Zgt_errno;
 
+/* One operation of a Tx, queued in the record of its tid (zgt_txrec)   */
+/* until a worker runs it. op is begintx, readtx, ...; it returns        */
+/* ZGT_OP_WAIT when the Tx has to wait for a lock, and is run again once */
+/* the lock is granted.                                                  */
+
+struct zgt_txrec;
+
 struct param
 {
   long tid, obno, count;
   char Txtype;
+  void *(*op)(void *);
+  param *next;  // Next operation of the same Tx
+  zgt_txrec *rec; // Record of the Tx; set by the worker that runs the op
+  long qtime;   // us it was scheduled; only kept if zgt_tm::opdone is set
+  long wstart;  // us it was parked; 0 if it is not
+  long wtime;   // us it spent parked
 };
 
+#define ZGT_OP_WAIT ((void *)1)
+
 
 
 
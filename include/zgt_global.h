@@ -12,16 +12,17 @@
 /* The main data structures used in this project: */
 // ZGT_Ht -- hash table data structure
 // ZGT_Sh  -- main tx manager data structure
-// ZGT_Key_sem  -- you need to set it to make it unique for each team
+// ZGT_Sema  -- in-process semaphores the Txs wait on
 // ZGT_Nsema -- total number of semaphores 
+// ZGT_Pool  -- slab pools of lock entries and operations
 
 #include<stddef.h>
 #define READWRITE 0
 
 int ZGT_Nsema;
 int errno;
-key_t  ZGT_Key_sem;
-int  ZGT_Semid;
+zgt_sema *ZGT_Sema;
+zgt_pool ZGT_Pool[ZGT_NPOOLS];
 
 zgt_ht * ZGT_Ht;
 zgt_tm * ZGT_Sh;
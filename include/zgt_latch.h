@@ -0,0 +1,44 @@
+//  Copyright [2021] [Himanshu Rijal]
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/* In-process latches and semaphores used by the Tx manager.  Both spin */
+/* for a short while and then park the thread on a futex, so an          */
+/* uncontended acquire/release never leaves user space.                  */
+
+#ifndef ZGT_LATCH_H
+#define ZGT_LATCH_H
+
+#define ZGT_LATCH_SPIN 100 // Spins before a latch/semaphore parks the thread
+
+/* Short-term mutual exclusion over a piece of the TM data structures. */
+/* state: 0 = free, 1 = held, 2 = held and somebody is parked on it    */
+
+struct zgt_latch
+{
+  volatile int state;
+};
+
+/* Counting semaphore; nwait is the # of threads blocked in zgt_p on it */
+
+struct zgt_sema
+{
+  volatile int count;
+  volatile int nwait;
+};
+
+extern void zgt_latch_init(zgt_latch *);
+extern void zgt_latch_acquire(zgt_latch *);
+extern void zgt_latch_release(zgt_latch *);
+
+#endif
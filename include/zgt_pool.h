@@ -0,0 +1,60 @@
+//  Copyright [2021] [Himanshu Rijal]
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/* Pools of fixed size objects (lock entries, operations, versions). */
+/* Objects are carved out of slabs that are never given back, so     */
+/* memory stays flat under load. Each thread keeps a cache of free   */
+/* objects per pool and only takes the pool latch to move a batch of */
+/* them in or out.                                                   */
+
+#ifndef ZGT_POOL_H
+#define ZGT_POOL_H
+
+#include <stddef.h>
+
+#define ZGT_POOL_HLINK  0  // zgt_hlink lock entries
+#define ZGT_POOL_PARAM  1  // param operations
+#define ZGT_POOL_VERSION 2 // zgt_version object versions
+#define ZGT_NPOOLS      3
+
+#define ZGT_POOL_SLAB   1024 // # of objects carved out of a slab at once
+#define ZGT_POOL_BATCH  64   // # of objects moved between a thread cache and its pool
+
+/* Free objects are chained through their first word */
+
+struct zgt_pool
+{
+  zgt_latch latch;
+  size_t size;     // Object size
+  void *free;      // Free objects not cached by any thread
+  void *slabs;     // Slabs allocated; chained through their first word
+  char *next;      // Uncarved part of the last slab
+  char *end;
+};
+
+/* Free objects cached by one thread for one pool */
+
+struct zgt_pcache
+{
+  void *head, *tail;
+  long n;
+};
+
+extern int zgt_init_pool(int, size_t);
+extern void *zgt_alloc(int);
+extern void zgt_free(int, void *);
+extern void zgt_free_chain(int, void *, void *, long);
+extern void zgt_pool_release();
+
+#endif
@@ -0,0 +1,92 @@
+//  Copyright [2021] [Himanshu Rijal]
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/* Lock manager statistics. Every thread counts what it does in a    */
+/* block of its own, with no latch and no shared cache line; reading */
+/* the statistics adds the blocks of all the threads up. Counts read */
+/* while the Txs run may be a few events behind.                     */
+
+#ifndef ZGT_STATS_H
+#define ZGT_STATS_H
+
+#include <stdio.h>
+
+#define ZGT_STATS_NHIST    32   // Histogram bucket b: [2^(b-1), 2^b) us; 0 us in bucket 0
+#define ZGT_STATS_TOPK     10   // Most contended objects reported
+#define ZGT_STATS_INTERVAL 1000 // Default ms between snapshots to the stats file
+
+/* Counts of one thread. Lock requests are indexed S = 0, X = 1 on an */
+/* object, and 2 on a segment, in any mode.                            */
+
+struct zgt_tstats
+{
+  long req[3];        // Lock requests
+  long grant[3];      // Granted at once
+  long waits[3];      // Had to wait
+  long wgrant[3];     // Granted after a wait
+  long upgrades;      // S held, X asked for
+  long escalations;   // Segments locked as a whole in place of object locks
+  long escobjs;       // Object locks those took out of the lock table
+  long dies;          // Requests that aborted the Tx instead of waiting (wait-die, victims)
+  long wounds;        // Younger holders aborted (wound-wait)
+  long deadlocks;     // Deadlocks found
+  long waitus;        // Time waited by the requests granted after a wait
+  long waithist[ZGT_STATS_NHIST];
+  long qsum, qmax;    // Entries queued on the object when a request had to wait
+  long commits, aborts;
+  long lifeus;        // Time from BeginTx to commit/abort
+  long lifehist[ZGT_STATS_NHIST];
+  long *objwaits;     // Per object: requests that waited on it
+  long *objwaitus;    // Per object: time they waited
+  zgt_tstats *next;
+};
+
+/* What a read returns: the counts of all the threads added up, the */
+/* objects waited on most, and how full the lock table is now       */
+
+struct zgt_stats
+{
+  zgt_tstats sum;       // objwaits/objwaitus are not set
+  int nthreads;
+  int ntop;
+  long topobj[ZGT_STATS_TOPK], topwaits[ZGT_STATS_TOPK], topwaitus[ZGT_STATS_TOPK];
+  long slots, used;     // Lock table slots, and those holding an object
+  int maxload;          // % of slots used in the fullest shard
+  long entries;         // Lock entries in the table
+  long maxqueue;        // Entries on the object with the most of them
+};
+
+extern __thread zgt_tstats *ZGT_Mystats;
+
+extern zgt_tstats *zgt_stats_register();
+extern void zgt_stats_add(zgt_stats *, int);
+extern void zgt_stats_print(FILE *, zgt_stats *);
+
+/* The block of the calling thread; set up the first time */
+
+static inline zgt_tstats *zgt_mystats()
+{
+  return((ZGT_Mystats != NULL) ? ZGT_Mystats : zgt_stats_register());
+}
+
+/* Adds a time to a histogram */
+
+static inline void zgt_stats_hist(long *hist, long us)
+{
+  int b = (us > 0) ? 64 - __builtin_clzl((unsigned long)us) : 0;
+
+  hist[(b < ZGT_STATS_NHIST) ? b : ZGT_STATS_NHIST - 1]++;
+}
+
+#endif
@@ -0,0 +1,77 @@
+//  Copyright [2021] [Himanshu Rijal]
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/* Multi-version object store. Every object keeps a chain of versions, */
+/* newest first, each stamped with the commit timestamp of the Tx that */
+/* wrote it. Read-only Txs read the versions committed before they     */
+/* began and never enter the lock table; the other Txs work on the     */
+/* newest version under their locks, as before.                        */
+
+#ifndef ZGT_STORE_H
+#define ZGT_STORE_H
+
+class zgt_tx;
+
+struct zgt_version
+{
+  zgt_version *prev; // Next older version; must stay first, as versions
+                     // are chained through it when given back to the pool
+  long cts;          // Commit timestamp; 0 while the writer has not committed
+  long tid;          // Tx that wrote it
+  int value;
+};
+
+/* Objects are kept side by side; 4 of them share a cache line */
+
+struct zgt_obj
+{
+  zgt_latch latch;   // Guards the version chain
+  zgt_version *head; // Newest version
+};
+
+class zgt_store
+{
+    public:
+
+        int nobj;
+
+        int valid(long obno) {return((obno >= 0) && (obno < nobj));}
+        int latest(long);           // newest value of an obj
+        int snapshot_read(long, long); // value of an obj as of a snapshot
+        int write(long, long);      // add 1 to an obj in a version of the Tx
+        long begin_commit();        // timestamp for a commit; serializes commits
+        void stamp(long, long, long); // make the version of a Tx visible as of a timestamp
+        void end_commit(long);
+        void rollback(long, long);  // drop the version of an aborting Tx
+        int written(long, long);    // Tx has a version of an obj not committed yet
+        long begin_snapshot(zgt_tx *);
+        void end_snapshot(zgt_tx *);
+        void load(long obno, int value) {objs[obno].head->value = value;} // before any Tx
+
+        zgt_store(int);
+        ~zgt_store();
+
+    private:
+
+        zgt_obj *objs;
+        zgt_latch latch;       // Guards clock and the snapshot list
+        volatile long clock;   // Timestamp of the last commit
+        volatile long horizon; // No snapshot older than this is active
+        zgt_tx *snaphead, *snaptail; // Read-only Txs active, oldest snapshot first
+
+        void set_horizon();
+        void prune(zgt_obj *);
+};
+
+#endif
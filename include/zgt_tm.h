@@ -1,28 +1,74 @@
 #include <stdio.h>
 #include <string>
 #include <stdlib.h>
+#include <time.h>
 #include "zgt_tx.h"
 #include <iostream>
 #include "zgt_def.h"
 #include "zgt_ddlock.h"
+#include "zgt_store.h"
+#include "zgt_wal.h"
+#include "zgt_trace.h"
+#include "zgt_stats.h"
 #define MAX_ITEMS 15
-#define MAX_TRANSACTIONS 10
 #define MAX_FILENAME 50
-#define NTHREADS 100
 
 using namespace std;
 
-class item
+struct param;
+
+static inline long zgt_usec() // us on a clock that only moves forward
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return(ts.tv_sec * 1000000L + ts.tv_nsec / 1000);
+}
+
+/* Entry of the Tx table, found by tid. Holds the operations of the   */
+/* Tx that are still to be done, in schedule order. A Tx is run by at */
+/* most one worker at a time, so its operations are done in order     */
+/* without any further synchronization. The Tx object itself is built */
+/* in txbuf. Once the Tx is out of the TM table and has no operation  */
+/* left, the record goes back to the free records, for any tid.       */
+
+struct zgt_txrec
 {
-  public:
-	int value;
+  zgt_latch latch;  // Guards the op queue and state
+  char state;       // I = idle, R = in the run queue, X = running, P = parked on a lock
+  int resumed;      // Lock was granted while the op that asked for it was running
+  long tid;         // Tx the record is in use for
+  zgt_txrec *nexth; // Next record in its hash chain, or among the free records
+  param *head, *tail;
+  zgt_txrec *nextrun; // Next Tx in the run queue; NULL at the end
+  int optime;
+  zgt_tx *tx;       // &txbuf while the Tx is in the TM table; NULL otherwise
+  node *wfnode;     // Its node in the wait-for graph; guarded by the graph's latch
+  zgt_tx txbuf;
+} __attribute__((aligned(64)));
 
-	item(int k){
-	  value=k;
-	};
+/* Records of the Tx table are allocated ZGT_TX_SLAB at a time, and */
+/* the slabs are kept until the TM goes away, so a record never     */
+/* moves; they are linked so all the records can be looked at.      */
 
-	~item();
- };
+struct zgt_txslab
+{
+  zgt_txslab *next;
+  zgt_txrec recs[ZGT_TX_SLAB];
+} __attribute__((aligned(64)));
+
+/* A shard of the Tx table: the records in use whose tid hashes to it, */
+/* in chains. The chain array doubles once there are more records than */
+/* chains. Records its tids give back are kept for its next new tids.  */
+
+struct zgt_txshard
+{
+  zgt_latch latch;
+  int size;          // # of chains; power of 2
+  int count;         // # of records in the chains
+  zgt_txrec **chains;
+  zgt_txrec *free;   // Records not in use by any tid
+} __attribute__((aligned(64)));
 
 class zgt_tm
 {
@@ -33,31 +79,53 @@ class zgt_tm
 	friend class wait_for;
 
 	long lastid;
-	zgt_tx *lastr;
-	zgt_hlink *head[ZGT_DEFAULT_HASH_TABLE_SIZE];
-	pthread_mutex_t mutexpool[MAX_TRANSACTIONS+1];
-	pthread_cond_t condpool[MAX_TRANSACTIONS+1];
-	int condset[MAX_TRANSACTIONS+1];
-	item *objarray[MAX_ITEMS];
-	int  optime[MAX_TRANSACTIONS+1];
+	zgt_latch txlatch; // Guards the slab list
+	zgt_txslab * volatile txslabs; // All the slabs of records, newest first
+	zgt_txshard txshards[1 << ZGT_TX_SHARD_BITS]; // Records in use, by tid
+	zgt_store *store;  // The objects, MAX_ITEMS unless told otherwise, with their versions
+	zgt_wal *wal;      // Redo log of the commits; NULL if there is none
   	int sem;
 	char *logfilename; // logfile -> logfilename
     FILE *logfile;
 
 	// Fall 2014[jay]. Pointer for wait_for => wait for graph
 	wait_for *waitgraph;
+	char ddmode;       // ZGT_DD_DETECT, ZGT_DD_WAIT_DIE or ZGT_DD_WOUND_WAIT
+	int ddinterval;    // ms between background deadlock checks; 0 = off
+	char ddvictim;     // ZGT_VICTIM_YOUNGEST or ZGT_VICTIM_FEWEST_LOCKS
+	pthread_t ddthread;
 
-    // Used to generate seq num for operations of EACH Tx.
-    // Every statement within a transaction is given a different number using SEQNUM[tid]
-    // and every statement waits on that value of count to match condset. condset is initialized to 0 and 
-    // decremented everytime an operation of a Tx finishes.
-    int SEQNUM[MAX_TRANSACTIONS+1];
-    pthread_t   threadid[NTHREADS];
+	// Objects are locked under a lock on their segment, obno / segsize,
+	// unless segsize is 0. A Tx with escalate object locks in a segment
+	// locks the segment as a whole instead; 0 = never.
+	int segsize;
+	int escalate;
+
+    // Fixed pool of workers that run the operations of all the Txs. Txs with
+    // an operation ready to run wait in the run queue (runhead..runtail);
+    // a Tx blocked on a lock is not in it and holds no worker.
+    int nworkers;
+    pthread_t *workers;
+    zgt_latch runlatch;
+    zgt_txrec * volatile runhead;
+    zgt_txrec *runtail;
+    volatile int nops;      // # of operations scheduled and not yet done
+    volatile int shutdown;
+
+    // Called by the worker as each operation is done, when set; the ops
+    // are then timed (qtime, wtime). zgt_bench drives the TM from it.
+    void (*opdone)(param *);
+
+    // Snapshots of the statistics go to statfile every statinterval ms
+    FILE *statfile;
+    int statinterval;
+    pthread_t statthread;
 
 	public:
 	
-		zgt_tm();
+		zgt_tm(int nobj = MAX_ITEMS);
         void openlog(string lfile);
+        int openwal(const char *, int); // redo log, and the flush window in us
         //Fall 2014[jay]. BeginTx modified for TxType; R= Read Only, W=Read/Write
 		int BeginTx(long tid, int thrNum,char Txtype);
 		int CommitTx(long tid, int thrNum);
@@ -65,7 +133,43 @@ class zgt_tm
 		int TxRead(long tid,long obno, int thrNum);
 		int TxWrite(long tid,long obno, int thrNum);
         int endTm(int thrNum);
+        void schedule(param *);  // queue an operation of a Tx
+        zgt_txrec *txalloc(long tid); // record of tid, allocated if needed; returned latched
+        zgt_txrec *txrec(long tid);   // record of tid; NULL if it has none now
+        void txrelease(zgt_txrec *, long tid); // give the record back if the Tx is done with it
+        void resume(long tid);   // a lock the Tx waits for was granted
+        void run_worker();
+        void settle();           // wait until no op is left to run but those parked
 		int ddlockDet();
 		int chooseVictim();
+		int resolveDdlock(int print);
+		int abortTx(long tid);  // abort a Tx chosen as victim or wounded
+		void run_ddlock();
+		void stats(zgt_stats *);     // lock manager statistics so far
+		void print_stats(FILE *);
+		int openstats(const char *, int); // snapshots to a file every so many ms
+		void run_stats();
 		~zgt_tm();
+
+	private:
+
+		zgt_txrec *txfind(zgt_txshard *, unsigned long, long);
+		zgt_txrec *txget(zgt_txshard *);
+		void txgrow(zgt_txshard *);
+
+		// Spreads consecutive tids over all shards and chains
+		// (splitmix64 finalizer, as for the lock table)
+
+		unsigned long txhash(long tid)
+			{
+				unsigned long h = (unsigned long)tid;
+				h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9UL;
+				h = (h ^ (h >> 27)) * 0x94d049bb133111ebUL;
+				return(h ^ (h >> 31));
+			}
+
+		// Top bits pick the shard, low bits the chain within the shard
+
+		zgt_txshard *txshard(unsigned long h)
+			{return(&txshards[h >> (64 - ZGT_TX_SHARD_BITS)]);}
 };
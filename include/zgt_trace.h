@@ -0,0 +1,106 @@
+//  Copyright [2021] [Himanshu Rijal]
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/* Binary trace of what the Txs do. Threads add fixed size records to */
+/* a ring buffer of their own without taking any latch; a background  */
+/* writer merges the rings in record order into the log file named in */
+/* the schedule and, unless told not to, prints them as the usual     */
+/* table. zgt_decode prints the table from a log file later on.       */
+
+#ifndef ZGT_TRACE_H
+#define ZGT_TRACE_H
+
+#include <stdio.h>
+
+#define ZGT_TRACE_PRINT 'P' // Log file, and the table on stdout
+#define ZGT_TRACE_FILE  'F' // Log file only
+#define ZGT_TRACE_OFF   'O' // Nothing is traced
+
+#define ZGT_TRACE_RING  4096 // Records per thread; power of 2
+#define ZGT_TRACE_MAGIC "ZGTTRC1\n" // First 8 bytes of a log file
+
+/* Record types; each stands for a line of the table, or a piece of one */
+
+#define ZGT_T_HEADER   'H' // Table header
+#define ZGT_T_BEGIN    'B' // BeginTx; c = Tx type
+#define ZGT_T_BEGINDUP 'b' // BeginTx of a Tx that exists
+#define ZGT_T_READ     'R' // Read under a lock; c = Tx status
+#define ZGT_T_SNAP     'S' // Snapshot read
+#define ZGT_T_WRITE    'W' // Write
+#define ZGT_T_OBJ      'o' // obno : value, of a Tx committing/aborting
+#define ZGT_T_NOENTRY  'e' // Lock entry of a Tx committing/aborting was not found
+#define ZGT_T_END      'E' // Ends a CommitTx/AbortTx line; c = TR_END/TR_ABORT
+#define ZGT_T_ENDNOTX  'n' // CommitTx/AbortTx of a Tx that does not exist
+#define ZGT_T_NOTX     'N' // Op of a Tx that does not exist; c = op
+#define ZGT_T_SKIP     'K' // Op of an aborted Tx; c = op
+#define ZGT_T_NOOBJ    'J' // Op on an obj not in the store; c = op
+#define ZGT_T_RDONLY   'Y' // Write in a read-only Tx
+#define ZGT_T_REABORT  'A' // AbortTx of an aborted Tx
+#define ZGT_T_NOREMOVE 'M' // Removing a Tx that is not in the TM table
+#define ZGT_T_NOLOCK   'L' // Lock entry could not be added
+#define ZGT_T_RANGE    'G' // Tx has no record; value = 0 if tid < 1, 1 if out of memory
+#define ZGT_T_CYCLE    'C' // Next Tx of a deadlock cycle
+#define ZGT_T_VICTIM   'V' // Ends a cycle back at tid; value = victim, 0 if none is chosen
+#define ZGT_T_NODDLK   'D' // No deadlock
+#define ZGT_T_ESCALATE 'X' // Segment locked as a whole; obno = sgno, value = object locks
+                           // taken out of the lock table, c = lock mode
+
+struct zgt_trec
+{
+  unsigned long seq;   // Order of the records over all threads
+  int tid;
+  int obno;
+  int value;
+  int optime;
+  unsigned short thr;  // Thread that added it; pieces of a line share it
+  char type;
+  char c;
+  int pad;
+};
+
+/* What the table printer keeps between records: the line each thread */
+/* is still putting together                                          */
+
+struct zgt_tline
+{
+  char *buf;
+  int len, size;
+};
+
+struct zgt_tfmt
+{
+  zgt_tline *lines;
+  int nlines;
+};
+
+extern char ZGT_Tracemode;
+
+extern void zgt_trace_rec(char, long, long, int, int, char);
+extern int zgt_trace_start();
+extern void zgt_trace_open(FILE *);
+extern void zgt_trace_sync();
+extern void zgt_trace_stop();
+extern void zgt_trace_print(FILE *, zgt_trec *, zgt_tfmt *);
+extern void zgt_trace_endfmt(zgt_tfmt *);
+
+/* Adds a record, unless tracing is off */
+
+static inline void zgt_trace(char type, long tid, long obno = 0, int value = 0,
+                                                int optime = 0, char c = ' ')
+{
+  if (ZGT_Tracemode != ZGT_TRACE_OFF)
+    zgt_trace_rec(type, tid, obno, value, optime, c);
+}
+
+#endif
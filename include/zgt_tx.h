@@ -13,19 +13,30 @@
 #include <stdlib.h>
 #include <sys/signal.h>
 #include <pthread.h>
+#include "zgt_latch.h"
+#include "zgt_pool.h"
 
 struct zgt_hlink
 {
+  zgt_hlink *nextp; // Links nodes of the same transaction; must stay first,
+                    // as a Tx's chain goes back to the pool as it is
   char lockmode;
+  char status;     // G = granted, W = waiting, U = holds lockmode and waits to convert
+                   // it to want, F = withdrawn; no longer in the queue of the object,
+                   // E = left the queue as the Tx locked the whole segment
+  char want;       // Mode asked for; differs from lockmode while converting
+  int count;       // Lock on a segment: object locks the Tx has in it, in the lock table
   long sgno;
   long obno;
   long tid;
   pthread_t pid;
 
-  zgt_hlink *next; // Links nodes hashed to the same bucket
-  zgt_hlink *nextp; // Links nodes of the same transaction
+  zgt_hlink *next; // Links the requests on the same object in FIFO order
+  zgt_hlink *prev;
 };
 
+struct zgt_stats;
+
 /* Local declarations */
 
 class zgt_tx
@@ -37,16 +48,29 @@ class zgt_tx
 
 
         long tid; //need a friend class here
-        pthread_t pid;
-        long sgno; // set to 1
+        long sgno; // Segment of the request it waits for
         long obno;
         char status;
         char lockmode;
         char Txtype; //transaction type R = Read-only or W = Read/Write
-        int semno;    // Txi uses semaphore i; sem 0 for TM
+        int narena;  // # of entries in the lock arena, withdrawn ones too
+        long ts;     // Begin order; smaller is older
+        int nlocks;  // # of lock requests of the Tx in the lock table
+        volatile int victim; // Set when the Tx has to abort at its next op
+        long snap;           // Read-only Tx: commits up to this timestamp are visible
+        zgt_tx *nexts, *prevs; // Read-only Txs active, in begin order (zgt_store)
+        long commitlsn;      // Committed; done once the redo log reaches it
+        zgt_tx *nextw;       // Txs waiting for the redo log, in lsn order
+        long btime;          // us it began
+        int optime;          // optime of its tid, from its record
+        long wstart;         // us it started to wait for a lock (0 if not waiting),
+                             // or for the redo log to reach its commit record
         zgt_hlink *head;           // head of lock table
+        zgt_hlink *last;           // Oldest entry; head..last is the lock arena of the Tx
+        zgt_hlink *seg;            // Its lock on the segment it last locked an object in
         zgt_hlink *others_lock(zgt_hlink *, long, long);
-        zgt_tx *nextr;
+        int cover(zgt_hlink *, long, char);
+        void escalate(zgt_hlink *);
 
     public :
 
@@ -58,19 +82,39 @@ class zgt_tx
         long get_tid(){return tid;}
         long set_tid(long t){tid = t; return tid;}
         char get_status() {return status;}
-        int set_lock(long, long, long, int, char);
+        int set_lock(long, long, long, char, zgt_hlink ** = NULL);
+        int lock_obj(long, long, char);
         int end_tx();
         int cleanup();
-        zgt_tx(long,char,char,pthread_t);
+        zgt_tx(long,char,char);
         void perform_readWrite(long, long, char);
-        int  setTx_semno(long, int);
         void print_tm();
-        // void  wait_for_operation(long );
-        // void  finish_operation(long);
         zgt_tx(){};
 };
 
 
+/* One slot of a lock table shard; holds all the lock entries of one object */
+
+struct zgt_hslot
+{
+  unsigned long hash; // Full hash of (sgno, obno); saves rehashing on probe/grow
+  long sgno;
+  long obno;
+  zgt_hlink *head;    // Lock entries on the object; NULL if the slot is free
+};
+
+/* A shard of the lock table. Slots are open addressed (linear probing) */
+/* and the slot array doubles once more than ZGT_HT_MAX_LOAD % is used. */
+/* Each shard has its own latch, aligned so shards do not share lines.  */
+
+struct zgt_hshard
+{
+  zgt_latch latch;
+  int size;          // # of slots; power of 2
+  int count;         // # of slots in use
+  zgt_hslot *slots;
+} __attribute__((aligned(64)));
+
 /* The Zeitgeist encapsulation object hash table class */
 
 class zgt_ht
@@ -84,9 +128,26 @@ class zgt_ht
 
         zgt_hlink *find (long, long); //find the obj in hash table
         zgt_hlink *findt (long, long, long); //find the tx obj belongs to
-        int add ( zgt_tx *, long, long, char); //add an obj for a tx to hash table
-        int remove ( zgt_tx *, long, long);  //remove a lock entry
+        int add ( zgt_tx *, long, long, char, char); //queue a lock request of a tx on an obj
+        int remove ( zgt_tx *, long, long);  //withdraw the lock entry of a tx
+        int release (zgt_hlink *);  //take an entry out of its obj queue
+        int conflicts (zgt_hlink *, long, char); //lockmode conflicts with locks granted to other txs
+        int compatible (char, char); //two modes may be granted to different txs at once
+        char convert (char, char); //weakest mode that covers both
+        int covers (char held, char m) {return (convert(held, m) == held);}
+        int waiters (zgt_hlink *); //# of requests waiting in an obj queue
+        int blocks (zgt_hlink *, zgt_hlink *, int); //an entry blocks a waiting request
+        int wakeup (long, long); //grant and wake up the waiters that are now compatible
         void print_ht();
+        void occupancy(zgt_stats *); //how full the table is
+
+        // Each shard has its own latch; find/add/remove on an object must be
+        // done with the latch of its shard held
+
+        void latch(long sgno, long obno)
+            {zgt_latch_acquire(&shard(hashing(sgno, obno))->latch);}
+        void unlatch(long sgno, long obno)
+            {zgt_latch_release(&shard(hashing(sgno, obno))->latch);}
 
         // Constructors & destructors
 
@@ -95,15 +156,25 @@ class zgt_ht
 
     private:
 
-        int  mask;
-        int size;
-        int hashing(long sgno, long obno)
-            {return((++sgno)*obno)&mask;}
-};
-
-
+        zgt_hshard shards[ZGT_HT_NSHARDS];
 
+        zgt_hslot *lookup(zgt_hshard *, unsigned long, long, long);
+        int grow(zgt_hshard *);
+        void unlink(zgt_hshard *, zgt_hslot *, zgt_hlink *);
 
+        // Mixes sgno and obno so that consecutive object numbers spread
+        // over all shards and slots (splitmix64 finalizer)
 
+        unsigned long hashing(long sgno, long obno)
+            {
+                unsigned long h = ((unsigned long)sgno << 32) ^ (unsigned long)obno;
+                h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9UL;
+                h = (h ^ (h >> 27)) * 0x94d049bb133111ebUL;
+                return(h ^ (h >> 31));
+            }
 
+        // Top bits pick the shard, low bits the slot within the shard
 
+        zgt_hshard *shard(unsigned long h)
+            {return(&shards[h >> (64 - ZGT_HT_SHARD_BITS)]);}
+};
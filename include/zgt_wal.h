@@ -0,0 +1,101 @@
+//  Copyright [2021] [Himanshu Rijal]
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/* Write-ahead redo log. A committing Tx adds the values it wrote to */
+/* the log buffer and gives up its locks; a flusher thread writes    */
+/* the buffer out with one fsync for all the commits that came in    */
+/* during the flush window (group commit), and only then are those  */
+/* Txs done. The objects are rebuilt from the log when it is opened. */
+
+#ifndef ZGT_WAL_H
+#define ZGT_WAL_H
+
+#include <pthread.h>
+
+#define ZGT_WAL_WINDOW  200        // Default flush window, us
+#define ZGT_WAL_CKPT    (1 << 20)  // Checkpoint once the log has this many bytes
+#define ZGT_WAL_MAGIC   0x5a47544cu // Starts every commit record
+#define ZGT_CKPT_MAGIC  "ZGTCKP1\n" // First 8 bytes of a checkpoint file
+
+class zgt_tx;
+class zgt_store;
+
+/* Commit record; followed by n zgt_walobj and a checksum of both */
+
+struct zgt_walrec
+{
+  unsigned int magic;
+  int n;           // # of objects written
+  long tid;
+  long cts;        // Commit timestamp
+};
+
+struct zgt_walobj
+{
+  int obno;
+  int value;
+};
+
+/* Buffer of commit records not written out yet */
+
+struct zgt_walbuf
+{
+  char *buf;
+  long len, size;
+};
+
+class zgt_wal
+{
+    public:
+
+        int open(const char *, zgt_store *); // replay, then start the flusher
+        void close();           // flush what is left and stop the flusher
+        void begin(long, long); // start the record of a committing Tx
+        void add(long, int);    // an obj it wrote, with its value
+        long end(zgt_tx *);     // the Tx waits for the record to be on disk
+        int durable(long lsn) {return(lsn <= flushed);}
+        void report();
+        void run_flusher();
+
+        int window;             // us the flusher waits for more commits
+
+        zgt_wal(int);
+        ~zgt_wal();
+
+    private:
+
+        char *path, *ckpath;
+        int fd, nobj;
+        int *image;             // Objects as of the log on disk; checkpointed
+        zgt_latch latch;        // Guards cur, appended and the waiters
+        zgt_walbuf cur, out;    // Being added to / being written out
+        long recoff;            // Start of the record being added in cur
+        int recn;               // # of objs in the record being added
+        long appended;          // lsn: bytes added to the log, ever
+        volatile long flushed;  // Bytes on disk
+        long logbytes;          // Bytes in the log file since the checkpoint
+        zgt_tx *whead, *wtail;  // Txs waiting for their record, in lsn order
+        volatile int stop;
+        pthread_t flusher;
+
+        long ncommits, nflushes, maxgroup; // For report
+        double latency;         // Sum of commit latencies, us
+        long start, elapsed;    // us the log was open
+
+        int replay();
+        int checkpoint();
+        void put(zgt_walbuf *, const void *, long);
+};
+
+#endif